@@ -30,9 +30,32 @@ static VKAPI_ATTR VkBool32 VKAPI_CALL VkDebugCallback(VkDebugUtilsMessageSeverit
 
 #endif
 
-void Application::Initialize()
+static void TransitionImageLayout(VkCommandBuffer commandBuffer, VkImage image, VkImageLayout oldLayout, VkImageLayout newLayout,
+    VkPipelineStageFlags srcStage, VkPipelineStageFlags dstStage, VkAccessFlags srcAccess, VkAccessFlags dstAccess)
 {
-	InitializeWindow();
+    VkImageMemoryBarrier barrier = {};
+    barrier.sType                           = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+    barrier.srcAccessMask                   = srcAccess;
+    barrier.dstAccessMask                   = dstAccess;
+    barrier.oldLayout                       = oldLayout;
+    barrier.newLayout                       = newLayout;
+    barrier.srcQueueFamilyIndex             = VK_QUEUE_FAMILY_IGNORED;
+    barrier.dstQueueFamilyIndex             = VK_QUEUE_FAMILY_IGNORED;
+    barrier.image                           = image;
+    barrier.subresourceRange.aspectMask     = VK_IMAGE_ASPECT_COLOR_BIT;
+    barrier.subresourceRange.baseMipLevel   = 0;
+    barrier.subresourceRange.levelCount     = 1;
+    barrier.subresourceRange.baseArrayLayer = 0;
+    barrier.subresourceRange.layerCount     = 1;
+
+    vkCmdPipelineBarrier(commandBuffer, srcStage, dstStage, 0, 0, nullptr, 0, nullptr, 1, &barrier);
+}
+
+void Application::Initialize(B32 isHeadless)
+{
+	m_isHeadless = isHeadless;
+
+	InitializeWindow(isHeadless);
 	InitializeVulkan();
 
 	m_isRunning = true;
@@ -48,13 +71,20 @@ void Application::Shutdown()
 	CleanUp();
 }
 
-void Application::InitializeWindow()
+void Application::InitializeWindow(B32 isHeadless)
 {
-	glfwInit();
+	VK_CHECK(!glfwInit(), "Failed to initialize GLFW.")
+
 	glfwWindowHint(GLFW_CLIENT_API, GLFW_NO_API);
 	glfwWindowHint(GLFW_RESIZABLE, GLFW_FALSE);
+	glfwWindowHint(GLFW_VISIBLE, isHeadless ? GLFW_FALSE : GLFW_TRUE);
 
 	m_window = glfwCreateWindow(960, 540, "Vulkan Engine", nullptr, nullptr);
+
+	VK_CHECK(m_window == nullptr, "Failed to create GLFW window.")
+
+	glfwSetWindowUserPointer(m_window, this);
+	glfwSetFramebufferSizeCallback(m_window, FramebufferResizeCallback);
 }
 
 void Application::InitializeVulkan()
@@ -64,6 +94,10 @@ void Application::InitializeVulkan()
     PickPhysicalDevice();
     CreateLogicalDevice();
     CreateSwapchain();
+    CreateSwapchainSemaphores();
+    CreateCommandPool();
+    CreateCommandBuffer();
+    CreateSyncObjects();
 }
 
 std::vector<const char*> Application::GetRequiredExtensions()
@@ -188,7 +222,9 @@ void Application::CreateVulkanInstance()
 
     VK_CHECK(vkCreateInstance(&instanceInfo, nullptr, &m_instance), "Failed to create Vulkan Instance.")
 
+#ifdef _DEBUG
     VK_CHECK(CreateDebugUtilsMessengerEXT(m_instance, &debugMessengerInfo, nullptr, &m_debugMessenger), "Failed to create Debug Messenger")
+#endif
 }
 
 void Application::CreateVulkanSurface()
@@ -277,6 +313,8 @@ void Application::CreateSwapchain()
     VkPresentModeKHR presentMode = PickSwapchainPresentMode(swapchainSupportDetails.presentModes);
     VkExtent2D extent = PickSwapchainExtent(swapchainSupportDetails.capabilities);
 
+    VK_CHECK(!(swapchainSupportDetails.capabilities.supportedUsageFlags & VK_IMAGE_USAGE_TRANSFER_DST_BIT), "Vulkan Swapchain images can't be cleared")
+
     U32 imageCount = swapchainSupportDetails.capabilities.minImageCount + 1;
 
     if (swapchainSupportDetails.capabilities.maxImageCount > 0 && imageCount > swapchainSupportDetails.capabilities.maxImageCount)
@@ -296,7 +334,7 @@ void Application::CreateSwapchain()
     swapchainInfo.imageColorSpace           = surfaceFormat.colorSpace;
     swapchainInfo.imageExtent               = extent;
     swapchainInfo.imageArrayLayers          = 1;
-    swapchainInfo.imageUsage                = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT;
+    swapchainInfo.imageUsage                = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT;
 
     if (indices.graphicsFamily != indices.presentFamily) 
     {
@@ -327,6 +365,168 @@ void Application::CreateSwapchain()
 
 }
 
+void Application::CreateSwapchainSemaphores()
+{
+    VkSemaphoreCreateInfo semaphoreInfo = {};
+    semaphoreInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+
+    m_renderFinishedSemaphores.resize(m_swapchainImages.size());
+
+    for (auto& semaphore : m_renderFinishedSemaphores)
+    {
+        VK_CHECK(vkCreateSemaphore(m_device, &semaphoreInfo, nullptr, &semaphore), "Failed to create Vulkan Semaphore");
+    }
+}
+
+void Application::CreateCommandPool()
+{
+    QueueFamilyIndices indices = FindQueueFamilies(m_physicalDevice);
+
+    VkCommandPoolCreateInfo poolInfo = {};
+    poolInfo.sType              = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+    //poolInfo.pNext            = nullptr;
+    poolInfo.flags              = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
+    poolInfo.queueFamilyIndex   = indices.graphicsFamily.value();
+
+    VK_CHECK(vkCreateCommandPool(m_device, &poolInfo, nullptr, &m_commandPool), "Failed to create Vulkan Command Pool");
+}
+
+void Application::CreateCommandBuffer()
+{
+    VkCommandBufferAllocateInfo allocInfo = {};
+    allocInfo.sType                 = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+    //allocInfo.pNext               = nullptr;
+    allocInfo.commandPool           = m_commandPool;
+    allocInfo.level                 = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+    allocInfo.commandBufferCount    = 1;
+
+    VK_CHECK(vkAllocateCommandBuffers(m_device, &allocInfo, &m_commandBuffer), "Failed to allocate Vulkan Command Buffer");
+}
+
+void Application::CreateSyncObjects()
+{
+    VkSemaphoreCreateInfo semaphoreInfo = {};
+    semaphoreInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+
+    VkFenceCreateInfo fenceInfo = {};
+    fenceInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+    fenceInfo.flags = VK_FENCE_CREATE_SIGNALED_BIT;
+
+    VK_CHECK(vkCreateSemaphore(m_device, &semaphoreInfo, nullptr, &m_imageAvailableSemaphore), "Failed to create Vulkan Semaphore");
+    VK_CHECK(vkCreateFence(m_device, &fenceInfo, nullptr, &m_inFlightFence), "Failed to create Vulkan Fence");
+}
+
+void Application::RecreateSwapchain()
+{
+    int width = 0, height = 0;
+    glfwGetFramebufferSize(m_window, &width, &height);
+
+    // Minimized : wait until the window has an area again
+    while (width == 0 || height == 0)
+    {
+        glfwWaitEvents();
+        glfwGetFramebufferSize(m_window, &width, &height);
+    }
+
+    vkDeviceWaitIdle(m_device);
+
+    CleanUpSwapchain();
+
+    CreateSwapchain();
+    CreateSwapchainSemaphores();
+}
+
+void Application::CleanUpSwapchain()
+{
+    for (auto semaphore : m_renderFinishedSemaphores)
+    {
+        vkDestroySemaphore(m_device, semaphore, nullptr);
+    }
+    m_renderFinishedSemaphores.clear();
+
+    vkDestroySwapchainKHR(m_device, m_swapchain, nullptr);
+    m_swapchain = VK_NULL_HANDLE;
+}
+
+void Application::RecordCommandBuffer(VkCommandBuffer commandBuffer, U32 imageIndex)
+{
+    VkCommandBufferBeginInfo beginInfo = {};
+    beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+    beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+
+    VK_CHECK(vkBeginCommandBuffer(commandBuffer, &beginInfo), "Failed to begin Vulkan Command Buffer");
+
+    if (m_frameRecordCallback)
+    {
+        m_frameRecordCallback(commandBuffer);
+    }
+
+    // Nothing is rendered yet : clear the acquired image so presented contents are defined, then hand it to present
+    VkImage image = m_swapchainImages[imageIndex];
+
+    TransitionImageLayout(commandBuffer, image,
+        VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+        VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT,
+        0, VK_ACCESS_TRANSFER_WRITE_BIT);
+
+    VkClearColorValue clearColor = { { 0.1f, 0.1f, 0.1f, 1.0f } };
+
+    VkImageSubresourceRange clearRange = {};
+    clearRange.aspectMask       = VK_IMAGE_ASPECT_COLOR_BIT;
+    clearRange.baseMipLevel     = 0;
+    clearRange.levelCount       = 1;
+    clearRange.baseArrayLayer   = 0;
+    clearRange.layerCount       = 1;
+
+    vkCmdClearColorImage(commandBuffer, image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, &clearColor, 1, &clearRange);
+
+    TransitionImageLayout(commandBuffer, image,
+        VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_PRESENT_SRC_KHR,
+        VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
+        VK_ACCESS_TRANSFER_WRITE_BIT, 0);
+
+    VK_CHECK(vkEndCommandBuffer(commandBuffer), "Failed to record Vulkan Command Buffer");
+}
+
+void Application::CreateBuffer(VkDeviceSize size, VkBufferUsageFlags usage, VkMemoryPropertyFlags properties, VkBuffer& buffer, VkDeviceMemory& bufferMemory)
+{
+    VkBufferCreateInfo bufferInfo = {};
+    bufferInfo.sType        = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+    bufferInfo.size         = size;
+    bufferInfo.usage        = usage;
+    bufferInfo.sharingMode  = VK_SHARING_MODE_EXCLUSIVE;
+
+    VK_CHECK(vkCreateBuffer(m_device, &bufferInfo, nullptr, &buffer), "Failed to create Vulkan Buffer");
+
+    VkMemoryRequirements memoryRequirements;
+    vkGetBufferMemoryRequirements(m_device, buffer, &memoryRequirements);
+
+    VkMemoryAllocateInfo allocInfo = {};
+    allocInfo.sType             = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+    allocInfo.allocationSize    = memoryRequirements.size;
+    allocInfo.memoryTypeIndex   = FindMemoryType(memoryRequirements.memoryTypeBits, properties);
+
+    VK_CHECK(vkAllocateMemory(m_device, &allocInfo, nullptr, &bufferMemory), "Failed to allocate Vulkan Buffer Memory");
+
+    vkBindBufferMemory(m_device, buffer, bufferMemory, 0);
+}
+
+U32 Application::FindMemoryType(U32 typeFilter, VkMemoryPropertyFlags properties)
+{
+    VkPhysicalDeviceMemoryProperties memoryProperties;
+    vkGetPhysicalDeviceMemoryProperties(m_physicalDevice, &memoryProperties);
+
+    for (U32 i = 0; i < memoryProperties.memoryTypeCount; i++)
+    {
+        if ((typeFilter & (1 << i)) && (memoryProperties.memoryTypes[i].propertyFlags & properties) == properties)
+        {
+            return i;
+        }
+    }
+
+    throw std::runtime_error("Failed to find a suitable Vulkan memory type.");
+}
+
 VkSurfaceFormatKHR Application::PickSwapchainFormat(const std::vector<VkSurfaceFormatKHR>& availableFormats)
 {
     for (const auto& availableFormat : availableFormats)
@@ -342,6 +542,12 @@ VkSurfaceFormatKHR Application::PickSwapchainFormat(const std::vector<VkSurfaceF
 
 VkPresentModeKHR Application::PickSwapchainPresentMode(const std::vector<VkPresentModeKHR>& availablePresentModes)
 {
+    // Headless runs are for measurement, so don't let vsync cap the frame rate
+    if (m_isHeadless && std::find(availablePresentModes.begin(), availablePresentModes.end(), VK_PRESENT_MODE_IMMEDIATE_KHR) != availablePresentModes.end())
+    {
+        return VK_PRESENT_MODE_IMMEDIATE_KHR;
+    }
+
     for (const auto& availablePresentMode : availablePresentModes) 
     {
         if (availablePresentMode == VK_PRESENT_MODE_MAILBOX_KHR) 
@@ -439,32 +645,158 @@ SwapchainSupportDetails Application::QuerySwapchainSupport(VkPhysicalDevice phys
     return details;
 }
 
+B32 Application::PumpFrame()
+{
+	glfwPollEvents();
+
+	return !glfwWindowShouldClose(m_window);
+}
+
+B32 Application::DrawFrame()
+{
+    m_lastSubmitTimeMs = 0.0;
+
+    if (m_isFramebufferResized)
+    {
+        m_isFramebufferResized = false;
+        RecreateSwapchain();
+    }
+
+    vkWaitForFences(m_device, 1, &m_inFlightFence, VK_TRUE, UINT64_MAX);
+
+    U32 imageIndex = 0;
+    VkResult acquireResult = vkAcquireNextImageKHR(m_device, m_swapchain, UINT64_MAX, m_imageAvailableSemaphore, VK_NULL_HANDLE, &imageIndex);
+
+    if (acquireResult == VK_ERROR_OUT_OF_DATE_KHR)
+    {
+        RecreateSwapchain();
+        return false;
+    }
+
+    VK_CHECK(acquireResult != VK_SUCCESS && acquireResult != VK_SUBOPTIMAL_KHR, "Failed to acquire Vulkan Swapchain image");
+
+    // Submission cost : everything from here to present returning, scene host work (e.g. staging writes) happens before DrawFrame
+    auto submitBegin = std::chrono::steady_clock::now();
+
+    vkResetFences(m_device, 1, &m_inFlightFence);
+
+    vkResetCommandBuffer(m_commandBuffer, 0);
+    RecordCommandBuffer(m_commandBuffer, imageIndex);
+
+    VkSemaphore waitSemaphores[] = { m_imageAvailableSemaphore };
+    VkPipelineStageFlags waitStages[] = { VK_PIPELINE_STAGE_TRANSFER_BIT };
+    VkSemaphore signalSemaphores[] = { m_renderFinishedSemaphores[imageIndex] };
+
+    VkSubmitInfo submitInfo = {};
+    submitInfo.sType                = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+    submitInfo.waitSemaphoreCount   = 1;
+    submitInfo.pWaitSemaphores      = waitSemaphores;
+    submitInfo.pWaitDstStageMask    = waitStages;
+    submitInfo.commandBufferCount   = 1;
+    submitInfo.pCommandBuffers      = &m_commandBuffer;
+    submitInfo.signalSemaphoreCount = 1;
+    submitInfo.pSignalSemaphores    = signalSemaphores;
+
+    VK_CHECK(vkQueueSubmit(m_graphicsQueue, 1, &submitInfo, m_inFlightFence), "Failed to submit Vulkan Command Buffer");
+
+    VkPresentInfoKHR presentInfo = {};
+    presentInfo.sType               = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR;
+    presentInfo.waitSemaphoreCount  = 1;
+    presentInfo.pWaitSemaphores     = signalSemaphores;
+    presentInfo.swapchainCount      = 1;
+    presentInfo.pSwapchains         = &m_swapchain;
+    presentInfo.pImageIndices       = &imageIndex;
+
+    VkResult presentResult = vkQueuePresentKHR(m_presentQueue, &presentInfo);
+
+    m_lastSubmitTimeMs = std::chrono::duration<F64, std::milli>(std::chrono::steady_clock::now() - submitBegin).count();
+
+    if (presentResult == VK_ERROR_OUT_OF_DATE_KHR || presentResult == VK_SUBOPTIMAL_KHR)
+    {
+        RecreateSwapchain();
+    }
+    else
+    {
+        VK_CHECK(presentResult, "Failed to present Vulkan Swapchain image");
+    }
+
+    return true;
+}
+
+void Application::ResizeWindow(I32 width, I32 height)
+{
+    glfwSetWindowSize(m_window, width, height);
+
+    m_isFramebufferResized = true;
+}
+
+void Application::SetFrameRecordCallback(std::function<void(VkCommandBuffer commandBuffer)> callback)
+{
+    m_frameRecordCallback = std::move(callback);
+}
+
+void Application::FramebufferResizeCallback(GLFWwindow* window, int width, int height)
+{
+    auto app = reinterpret_cast<Application*>(glfwGetWindowUserPointer(window));
+    app->m_isFramebufferResized = true;
+}
+
 void Application::MessageLoop()
 {
-	while (!glfwWindowShouldClose(m_window))
+	while (PumpFrame())
 	{
-		glfwPollEvents();
 	}
 }
 
 void Application::CleanUp()
 {
-    vkDestroySwapchainKHR(m_device, m_swapchain, nullptr);
+    // Safe to call after a partial Initialize : every handle starts out null
+    if (m_device != VK_NULL_HANDLE)
+    {
+        vkDeviceWaitIdle(m_device);
+
+        vkDestroyFence(m_device, m_inFlightFence, nullptr);
+        vkDestroySemaphore(m_device, m_imageAvailableSemaphore, nullptr);
+        vkDestroyCommandPool(m_device, m_commandPool, nullptr);
 
-    vkDestroyDevice(m_device, nullptr);
+        CleanUpSwapchain();
 
+        vkDestroyDevice(m_device, nullptr);
+
+        m_inFlightFence = VK_NULL_HANDLE;
+        m_imageAvailableSemaphore = VK_NULL_HANDLE;
+        m_commandPool = VK_NULL_HANDLE;
+        m_commandBuffer = VK_NULL_HANDLE;
+        m_device = VK_NULL_HANDLE;
+    }
+
+    if (m_instance != VK_NULL_HANDLE)
+    {
 #ifdef _DEBUG
-	DestroyDebugUtilsMessengerEXT(m_instance, m_debugMessenger, nullptr);
+        if (m_debugMessenger != VK_NULL_HANDLE)
+        {
+            DestroyDebugUtilsMessengerEXT(m_instance, m_debugMessenger, nullptr);
+            m_debugMessenger = VK_NULL_HANDLE;
+        }
 #endif // _DEBUG
 
-    vkDestroySurfaceKHR(m_instance, m_surface, nullptr);
+        vkDestroySurfaceKHR(m_instance, m_surface, nullptr);
+        vkDestroyInstance(m_instance, nullptr);
+
+        m_surface = VK_NULL_HANDLE;
+        m_instance = VK_NULL_HANDLE;
+    }
 
-	vkDestroyInstance(m_instance, nullptr);
+    if (m_window != nullptr)
+    {
+        glfwDestroyWindow(m_window);
+        m_window = nullptr;
+    }
 
-	glfwDestroyWindow(m_window);
 	glfwTerminate();
 }
 
+#ifdef _DEBUG
 VkResult Application::CheckValidationLayerSupport()
 {
     U32 layerCount;
@@ -492,3 +824,4 @@ VkResult Application::CheckValidationLayerSupport()
 
     return VK_SUCCESS;
 }
+#endif // _DEBUG
@@ -5,12 +5,25 @@
 class Application
 {
 public:
-	void Initialize();
+	void Initialize(B32 isHeadless = false);
 	void Run();
 	void Shutdown();
 
+	B32 PumpFrame();
+	B32 DrawFrame();		// False when the frame was skipped for a swapchain recreate
+	void ResizeWindow(I32 width, I32 height);
+
+	// Extra commands recorded at the start of every frame, after the in-flight fence has signalled.
+	// The engine records nothing here itself : it lets the benchmark inject synthetic workloads.
+	void SetFrameRecordCallback(std::function<void(VkCommandBuffer commandBuffer)> callback);
+
+	void CreateBuffer(VkDeviceSize size, VkBufferUsageFlags usage, VkMemoryPropertyFlags properties, VkBuffer& buffer, VkDeviceMemory& bufferMemory);
+
+	VkDevice GetDevice() const { return m_device; }
+	F64 GetLastSubmitTimeMs() const { return m_lastSubmitTimeMs; }
+
 private:
-	void InitializeWindow();
+	void InitializeWindow(B32 isHeadless);
 	void InitializeVulkan();
 
 	//void SetupDebugMessenger();
@@ -19,6 +32,16 @@ private:
 	void PickPhysicalDevice();
 	void CreateLogicalDevice();
 	void CreateSwapchain();
+	void CreateSwapchainSemaphores();
+	void CreateCommandPool();
+	void CreateCommandBuffer();
+	void CreateSyncObjects();
+
+	void RecreateSwapchain();
+	void CleanUpSwapchain();
+	void RecordCommandBuffer(VkCommandBuffer commandBuffer, U32 imageIndex);
+
+	U32 FindMemoryType(U32 typeFilter, VkMemoryPropertyFlags properties);
 
 	VkSurfaceFormatKHR PickSwapchainFormat(const std::vector<VkSurfaceFormatKHR> &availableFormats);
 	VkPresentModeKHR PickSwapchainPresentMode(const std::vector<VkPresentModeKHR>& availablePresentModes);
@@ -35,6 +58,8 @@ private:
 
 	void MessageLoop();
 
+	static void FramebufferResizeCallback(GLFWwindow* window, int width, int height);
+
 	void CleanUp();
 
 #ifdef _DEBUG
@@ -44,21 +69,32 @@ private:
 
 private:
 	bool m_isRunning = false;
+	B32 m_isHeadless = false;
+	B32 m_isFramebufferResized = false;
 
-	GLFWwindow*				m_window;
-	VkInstance				m_instance;
-	VkSurfaceKHR			m_surface;
+	GLFWwindow*				m_window			= nullptr;
+	VkInstance				m_instance			= VK_NULL_HANDLE;
+	VkSurfaceKHR			m_surface			= VK_NULL_HANDLE;
 	VkPhysicalDevice		m_physicalDevice	= VK_NULL_HANDLE;
 	VkDevice				m_device			= VK_NULL_HANDLE;
 	VkQueue					m_graphicsQueue;
 	VkQueue					m_presentQueue;
-	VkSwapchainKHR			m_swapchain;
+	VkSwapchainKHR			m_swapchain			= VK_NULL_HANDLE;
 	std::vector<VkImage>	m_swapchainImages;
 	VkFormat				m_swapchainFormat;
 	VkExtent2D				m_swapchainExtent;
 
+	VkCommandPool				m_commandPool				= VK_NULL_HANDLE;
+	VkCommandBuffer				m_commandBuffer				= VK_NULL_HANDLE;
+	VkSemaphore					m_imageAvailableSemaphore	= VK_NULL_HANDLE;
+	std::vector<VkSemaphore>	m_renderFinishedSemaphores;		// One per swapchain image
+	VkFence						m_inFlightFence				= VK_NULL_HANDLE;
+	F64							m_lastSubmitTimeMs			= 0.0;		// CPU time from image acquired to present returned : record, submit and present of the last frame
+
+	std::function<void(VkCommandBuffer commandBuffer)> m_frameRecordCallback;
+
 #ifdef _DEBUG
-	VkDebugUtilsMessengerEXT m_debugMessenger;
+	VkDebugUtilsMessengerEXT m_debugMessenger = VK_NULL_HANDLE;
 #endif // _DEBUG
 
 private:
@@ -0,0 +1,571 @@
+#include "Benchmark.h"
+
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <cmath>
+#include <cstdio>
+
+#include <psapi.h>
+
+#ifdef _DEBUG
+static const char* k_buildConfig = "Debug";
+#else
+static const char* k_buildConfig = "Release";
+#endif // _DEBUG
+
+static const size_t k_heavyUploadSize = 32 * 1024 * 1024;
+
+// Synthetic workload for HeavyUpload, owned by the benchmark and injected through the frame record callback.
+// Two staging buffers alternate, so the host write for a frame never touches the buffer the previous,
+// possibly still in flight, frame copies from.
+struct UploadWorkload
+{
+	VkDevice		device				= VK_NULL_HANDLE;
+	VkBuffer		stagingBuffers[2]	= {};
+	VkDeviceMemory	stagingMemory[2]	= {};
+	void*			stagingMapped[2]	= {};
+	VkBuffer		buffer				= VK_NULL_HANDLE;
+	VkDeviceMemory	memory				= VK_NULL_HANDLE;
+	U32				current				= 0;
+};
+
+static UploadWorkload s_uploadWorkload;
+
+static void CreateUploadWorkload(Application& app)
+{
+	s_uploadWorkload.device = app.GetDevice();
+
+	for (U32 i = 0; i < 2; i++)
+	{
+		app.CreateBuffer(k_heavyUploadSize, VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+			VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+			s_uploadWorkload.stagingBuffers[i], s_uploadWorkload.stagingMemory[i]);
+
+		VK_CHECK(vkMapMemory(s_uploadWorkload.device, s_uploadWorkload.stagingMemory[i], 0, k_heavyUploadSize, 0, &s_uploadWorkload.stagingMapped[i]), "Failed to map Vulkan Buffer Memory");
+	}
+
+	app.CreateBuffer(k_heavyUploadSize, VK_BUFFER_USAGE_TRANSFER_DST_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+		s_uploadWorkload.buffer, s_uploadWorkload.memory);
+
+	app.SetFrameRecordCallback([](VkCommandBuffer commandBuffer)
+	{
+		VkBufferCopy copyRegion = {};
+		copyRegion.size = k_heavyUploadSize;
+
+		vkCmdCopyBuffer(commandBuffer, s_uploadWorkload.stagingBuffers[s_uploadWorkload.current], s_uploadWorkload.buffer, 1, &copyRegion);
+	});
+}
+
+static void DestroyUploadWorkload(Application& app)
+{
+	app.SetFrameRecordCallback(nullptr);
+
+	if (s_uploadWorkload.device == VK_NULL_HANDLE)
+	{
+		return;
+	}
+
+	vkDeviceWaitIdle(s_uploadWorkload.device);
+
+	for (U32 i = 0; i < 2; i++)
+	{
+		if (s_uploadWorkload.stagingMapped[i] != nullptr)
+		{
+			vkUnmapMemory(s_uploadWorkload.device, s_uploadWorkload.stagingMemory[i]);
+		}
+
+		vkDestroyBuffer(s_uploadWorkload.device, s_uploadWorkload.stagingBuffers[i], nullptr);
+		vkFreeMemory(s_uploadWorkload.device, s_uploadWorkload.stagingMemory[i], nullptr);
+	}
+
+	vkDestroyBuffer(s_uploadWorkload.device, s_uploadWorkload.buffer, nullptr);
+	vkFreeMemory(s_uploadWorkload.device, s_uploadWorkload.memory, nullptr);
+
+	s_uploadWorkload = {};
+}
+
+static const I32 k_resizeStormSizes[][2] = { { 960, 540 }, { 1280, 720 }, { 640, 360 }, { 1920, 1080 } };
+
+const std::vector<BenchmarkScene> Benchmark::k_scenes =
+{
+	{
+		"EmptyFrame",
+		nullptr,
+		[](Application& app, U32 frameIndex)
+		{
+			app.PumpFrame();
+			return app.DrawFrame();
+		},
+		nullptr
+	},
+	{
+		"HeavyUpload",
+		CreateUploadWorkload,
+		[](Application& app, U32 frameIndex)
+		{
+			// DrawFrame has already waited on the frame that last copied from this staging buffer
+			s_uploadWorkload.current ^= 1;
+			std::memset(s_uploadWorkload.stagingMapped[s_uploadWorkload.current], static_cast<int>(frameIndex & 0xFF), k_heavyUploadSize);
+
+			app.PumpFrame();
+			return app.DrawFrame();
+		},
+		DestroyUploadWorkload
+	},
+	{
+		"ResizeStorm",
+		nullptr,
+		[](Application& app, U32 frameIndex)
+		{
+			const I32* size = k_resizeStormSizes[frameIndex % std::size(k_resizeStormSizes)];
+
+			app.ResizeWindow(size[0], size[1]);
+			app.PumpFrame();
+			return app.DrawFrame();
+		},
+		nullptr
+	},
+};
+
+// Results files are a regression gate, so a missing or malformed field is an error rather than a default
+static std::string ExtractString(const std::string& object, const std::string& key)
+{
+	size_t keyPos = object.find("\"" + key + "\"");
+	size_t colonPos = (keyPos == std::string::npos) ? std::string::npos : object.find(':', keyPos);
+	size_t begin = (colonPos == std::string::npos) ? std::string::npos : object.find('"', colonPos + 1);
+	size_t end = (begin == std::string::npos) ? std::string::npos : object.find('"', begin + 1);
+
+	if (end == std::string::npos || end == begin + 1)
+	{
+		throw std::runtime_error("Missing or malformed \"" + key + "\" in benchmark results");
+	}
+
+	return object.substr(begin + 1, end - begin - 1);
+}
+
+static F64 ExtractNumber(const std::string& object, const std::string& key)
+{
+	size_t keyPos = object.find("\"" + key + "\"");
+	size_t colonPos = (keyPos == std::string::npos) ? std::string::npos : object.find(':', keyPos);
+
+	if (colonPos == std::string::npos)
+	{
+		throw std::runtime_error("Missing \"" + key + "\" in benchmark results");
+	}
+
+	const char* begin = object.c_str() + colonPos + 1;
+	char* end = nullptr;
+	F64 value = std::strtod(begin, &end);
+
+	if (end == begin || !std::isfinite(value) || value < 0.0)
+	{
+		throw std::runtime_error("Malformed \"" + key + "\" in benchmark results");
+	}
+
+	return value;
+}
+
+// Tears the scene and application down even when a scene throws, so a failed scene can't leak Vulkan or GLFW state
+struct ShutdownGuard
+{
+	Application& app;
+	const BenchmarkScene& scene;
+
+	~ShutdownGuard()
+	{
+		if (scene.Teardown != nullptr)
+		{
+			scene.Teardown(app);
+		}
+
+		app.Shutdown();
+	}
+};
+
+Benchmark::Benchmark(const BenchmarkConfig& config)
+	: m_config(config)
+{
+}
+
+void Benchmark::Run()
+{
+	m_results.clear();
+
+	// Each scene runs in its own process so its peak memory and GLFW state don't leak into the next one
+	B32 isSceneProcess = !m_config.sceneName.empty();
+
+	for (const auto& scene : k_scenes)
+	{
+		if (isSceneProcess)
+		{
+			if (m_config.sceneName == scene.name)
+			{
+				m_results.push_back(RunScene(scene));
+			}
+
+			continue;
+		}
+
+		BenchmarkResult result = RunSceneProcess(scene);
+
+		std::cout << std::fixed << std::setprecision(3)
+			<< scene.name
+			<< " : startup " << result.startupMs << " ms"
+			<< ", p50 " << result.frameP50Ms << " ms"
+			<< ", p95 " << result.frameP95Ms << " ms"
+			<< ", p99 " << result.frameP99Ms << " ms"
+			<< ", submit " << result.cpuSubmitMs << " ms/frame"
+			<< ", peak " << result.peakMemoryMB << " MB" << std::endl;
+
+		m_results.push_back(result);
+	}
+
+	if (isSceneProcess && m_results.empty())
+	{
+		throw std::runtime_error("Unknown benchmark scene: " + m_config.sceneName);
+	}
+}
+
+BenchmarkResult Benchmark::RunScene(const BenchmarkScene& scene)
+{
+	using Clock = std::chrono::steady_clock;
+
+	BenchmarkResult result = {};
+	result.scene = scene.name;
+	result.frameCount = m_config.frameCount;
+
+	std::vector<F64> frameTimes;
+	frameTimes.reserve(m_config.frameCount);
+
+	F64 submitTotalMs = 0.0;
+	U32 submittedFrames = 0;
+
+	{
+		Application app = Application();
+		ShutdownGuard shutdownGuard = { app, scene };
+
+		auto startupBegin = Clock::now();
+		app.Initialize(true);
+		result.startupMs = std::chrono::duration<F64, std::milli>(Clock::now() - startupBegin).count();
+
+		if (scene.Setup != nullptr)
+		{
+			scene.Setup(app);
+		}
+
+		for (U32 i = 0; i < m_config.warmupFrames; i++)
+		{
+			scene.Frame(app, i);
+		}
+
+		for (U32 i = 0; i < m_config.frameCount; i++)
+		{
+			auto frameBegin = Clock::now();
+			B32 isSubmitted = scene.Frame(app, i);
+			frameTimes.push_back(std::chrono::duration<F64, std::milli>(Clock::now() - frameBegin).count());
+
+			// Frames skipped for a swapchain recreate submitted nothing, so they don't dilute the average
+			if (isSubmitted)
+			{
+				submitTotalMs += app.GetLastSubmitTimeMs();
+				submittedFrames++;
+			}
+		}
+	}
+
+	if (submittedFrames == 0)
+	{
+		throw std::runtime_error("Benchmark scene submitted no frames: " + result.scene);
+	}
+
+	std::sort(frameTimes.begin(), frameTimes.end());
+
+	result.frameP50Ms = Percentile(frameTimes, 50.0);
+	result.frameP95Ms = Percentile(frameTimes, 95.0);
+	result.frameP99Ms = Percentile(frameTimes, 99.0);
+	result.cpuSubmitMs = submitTotalMs / submittedFrames;
+	result.peakMemoryMB = GetPeakMemoryMB();
+
+	return result;
+}
+
+BenchmarkResult Benchmark::RunSceneProcess(const BenchmarkScene& scene)		//TODO: Platform Specific : Refactor to platform layer
+{
+	char executablePath[MAX_PATH] = {};
+	GetModuleFileNameA(nullptr, executablePath, MAX_PATH);
+
+	std::string scenePath = m_config.outputPath + "." + scene.name + ".json";
+
+	std::string commandLine = "\"" + std::string(executablePath) + "\""
+		+ " --scene " + scene.name
+		+ " --frames " + std::to_string(m_config.frameCount)
+		+ " --warmup " + std::to_string(m_config.warmupFrames)
+		+ " --output \"" + scenePath + "\"";
+
+	STARTUPINFOA startupInfo = {};
+	startupInfo.cb = sizeof(startupInfo);
+
+	PROCESS_INFORMATION processInfo = {};
+
+	if (!CreateProcessA(nullptr, commandLine.data(), nullptr, nullptr, FALSE, 0, nullptr, nullptr, &startupInfo, &processInfo))
+	{
+		throw std::runtime_error("Failed to launch benchmark process for scene: " + std::string(scene.name));
+	}
+
+	// A hung scene (e.g. a hidden window that never gets a framebuffer) must not block the gate forever
+	DWORD timeoutMs = static_cast<DWORD>(std::min<U64>(static_cast<U64>(m_config.sceneTimeout) * 1000, INFINITE - 1));
+	B32 isTimedOut = WaitForSingleObject(processInfo.hProcess, timeoutMs) == WAIT_TIMEOUT;
+
+	if (isTimedOut)
+	{
+		TerminateProcess(processInfo.hProcess, EXIT_FAILURE);
+		WaitForSingleObject(processInfo.hProcess, INFINITE);
+	}
+
+	DWORD exitCode = EXIT_FAILURE;
+	GetExitCodeProcess(processInfo.hProcess, &exitCode);
+
+	CloseHandle(processInfo.hThread);
+	CloseHandle(processInfo.hProcess);
+
+	if (isTimedOut)
+	{
+		std::remove(scenePath.c_str());
+		throw std::runtime_error("Benchmark scene timed out after " + std::to_string(m_config.sceneTimeout) + " s: " + std::string(scene.name));
+	}
+
+	if (exitCode != EXIT_SUCCESS)
+	{
+		throw std::runtime_error("Benchmark scene failed: " + std::string(scene.name));
+	}
+
+	BenchmarkReport report = ReadResults(scenePath);
+	std::remove(scenePath.c_str());
+
+	if (report.scenes.size() != 1 || report.scenes[0].scene != scene.name)
+	{
+		throw std::runtime_error("Benchmark scene process wrote unexpected results: " + scenePath);
+	}
+
+	return report.scenes[0];
+}
+
+void Benchmark::WriteResults()
+{
+	std::ofstream file(m_config.outputPath);
+	if (!file.is_open())
+	{
+		throw std::runtime_error("Failed to open benchmark output file: " + m_config.outputPath);
+	}
+
+	file << std::fixed << std::setprecision(6);
+	file << "{\n";
+	file << "    \"build\": \"" << k_buildConfig << "\",\n";
+	file << "    \"frameCount\": " << m_config.frameCount << ",\n";
+	file << "    \"warmupFrames\": " << m_config.warmupFrames << ",\n";
+	file << "    \"scenes\": [\n";
+
+	for (size_t i = 0; i < m_results.size(); i++)
+	{
+		const BenchmarkResult& result = m_results[i];
+
+		file << "        {\n";
+		file << "            \"scene\": \"" << result.scene << "\",\n";
+		file << "            \"frameCount\": " << result.frameCount << ",\n";
+		file << "            \"startupMs\": " << result.startupMs << ",\n";
+		file << "            \"frameP50Ms\": " << result.frameP50Ms << ",\n";
+		file << "            \"frameP95Ms\": " << result.frameP95Ms << ",\n";
+		file << "            \"frameP99Ms\": " << result.frameP99Ms << ",\n";
+		file << "            \"cpuSubmitMs\": " << result.cpuSubmitMs << ",\n";
+		file << "            \"peakMemoryMB\": " << result.peakMemoryMB << "\n";
+		file << "        }" << (i + 1 < m_results.size() ? "," : "") << "\n";
+	}
+
+	file << "    ]\n";
+	file << "}\n";
+
+	std::cout << "Benchmark results written to " << m_config.outputPath << std::endl;
+}
+
+B32 Benchmark::CompareAgainstBaseline()
+{
+	BenchmarkReport baseline = ReadResults(m_config.baselinePath);
+
+	B32 isPassing = true;
+
+	// Anything that makes the runs incomparable fails the gate instead of being skipped
+	if (baseline.build != k_buildConfig)
+	{
+		std::cout << "MISMATCH build : " << k_buildConfig << " vs baseline " << baseline.build << std::endl;
+
+		isPassing = false;
+	}
+
+	if (baseline.frameCount != m_config.frameCount || baseline.warmupFrames != m_config.warmupFrames)
+	{
+		std::cout << "MISMATCH frames/warmup : " << m_config.frameCount << "/" << m_config.warmupFrames
+			<< " vs baseline " << baseline.frameCount << "/" << baseline.warmupFrames << std::endl;
+
+		isPassing = false;
+	}
+
+	if (baseline.scenes.empty())
+	{
+		std::cout << "MISSING baseline has no scenes" << std::endl;
+
+		isPassing = false;
+	}
+
+	for (const auto& baselineResult : baseline.scenes)
+	{
+		// A --scene run only produces the selected scene, so only that one is expected
+		if (!m_config.sceneName.empty() && baselineResult.scene != m_config.sceneName)
+		{
+			continue;
+		}
+
+		auto result = std::find_if(m_results.begin(), m_results.end(),
+			[&baselineResult](const BenchmarkResult& entry) { return entry.scene == baselineResult.scene; });
+
+		if (result == m_results.end())
+		{
+			std::cout << "MISSING " << baselineResult.scene << " : in baseline but not in this run" << std::endl;
+
+			isPassing = false;
+		}
+	}
+
+	for (const auto& result : m_results)
+	{
+		auto baselineResult = std::find_if(baseline.scenes.begin(), baseline.scenes.end(),
+			[&result](const BenchmarkResult& entry) { return entry.scene == result.scene; });
+
+		if (baselineResult == baseline.scenes.end())
+		{
+			std::cout << "MISSING " << result.scene << " : not in baseline" << std::endl;
+
+			isPassing = false;
+			continue;
+		}
+
+		const std::pair<const char*, std::pair<F64, F64>> metrics[] =
+		{
+			{ "startupMs",		{ result.startupMs,		baselineResult->startupMs } },
+			{ "frameP50Ms",		{ result.frameP50Ms,	baselineResult->frameP50Ms } },
+			{ "frameP95Ms",		{ result.frameP95Ms,	baselineResult->frameP95Ms } },
+			{ "frameP99Ms",		{ result.frameP99Ms,	baselineResult->frameP99Ms } },
+			{ "cpuSubmitMs",	{ result.cpuSubmitMs,	baselineResult->cpuSubmitMs } },
+			{ "peakMemoryMB",	{ result.peakMemoryMB,	baselineResult->peakMemoryMB } },
+		};
+
+		for (const auto& metric : metrics)
+		{
+			F64 current = metric.second.first;
+			F64 reference = metric.second.second;
+			F64 limit = reference * (1.0 + m_config.tolerance);
+
+			if (current > limit)
+			{
+				std::cout << std::fixed << std::setprecision(3)
+					<< "REGRESSION " << result.scene << "." << metric.first
+					<< " : " << current << " > " << limit
+					<< " (baseline " << reference << ")" << std::endl;
+
+				isPassing = false;
+			}
+		}
+	}
+
+	std::cout << (isPassing ? "No regressions against " : "Baseline check failed against ") << m_config.baselinePath << std::endl;
+
+	return isPassing;
+}
+
+BenchmarkReport Benchmark::ReadResults(const std::string& path)
+{
+	std::ifstream file(path);
+	if (!file.is_open())
+	{
+		throw std::runtime_error("Failed to open benchmark results file: " + path);
+	}
+
+	std::stringstream buffer;
+	buffer << file.rdbuf();
+	std::string json = buffer.str();
+
+	size_t scenesBegin = json.find("\"scenes\"");
+	size_t scenesEnd = (scenesBegin == std::string::npos) ? std::string::npos : json.find(']', scenesBegin);
+	if (scenesEnd == std::string::npos)
+	{
+		throw std::runtime_error("Missing \"scenes\" in benchmark results file: " + path);
+	}
+
+	std::string header = json.substr(0, scenesBegin);
+
+	BenchmarkReport report = {};
+	report.build		= ExtractString(header, "build");
+	report.frameCount	= static_cast<U32>(ExtractNumber(header, "frameCount"));
+	report.warmupFrames	= static_cast<U32>(ExtractNumber(header, "warmupFrames"));
+
+	// Results are written one flat object per scene, so each scene spans a single {...} block
+	size_t position = scenesBegin;
+	while (true)
+	{
+		size_t begin = json.find('{', position);
+		if (begin == std::string::npos || begin > scenesEnd)
+		{
+			break;
+		}
+
+		size_t end = json.find('}', begin);
+		if (end == std::string::npos)
+		{
+			throw std::runtime_error("Malformed scene entry in benchmark results file: " + path);
+		}
+
+		std::string object = json.substr(begin, end - begin + 1);
+
+		BenchmarkResult entry = {};
+		entry.scene			= ExtractString(object, "scene");
+		entry.frameCount	= static_cast<U32>(ExtractNumber(object, "frameCount"));
+		entry.startupMs		= ExtractNumber(object, "startupMs");
+		entry.frameP50Ms	= ExtractNumber(object, "frameP50Ms");
+		entry.frameP95Ms	= ExtractNumber(object, "frameP95Ms");
+		entry.frameP99Ms	= ExtractNumber(object, "frameP99Ms");
+		entry.cpuSubmitMs	= ExtractNumber(object, "cpuSubmitMs");
+		entry.peakMemoryMB	= ExtractNumber(object, "peakMemoryMB");
+		report.scenes.push_back(entry);
+
+		position = end + 1;
+	}
+
+	return report;
+}
+
+F64 Benchmark::Percentile(const std::vector<F64>& sortedFrameTimes, F64 percentile)
+{
+	if (sortedFrameTimes.empty())
+	{
+		return 0.0;
+	}
+
+	// Nearest rank
+	size_t rank = static_cast<size_t>(std::ceil(percentile / 100.0 * sortedFrameTimes.size()));
+	rank = std::clamp<size_t>(rank, 1, sortedFrameTimes.size());
+
+	return sortedFrameTimes[rank - 1];
+}
+
+F64 Benchmark::GetPeakMemoryMB()		//TODO: Platform Specific : Refactor to platform layer
+{
+	PROCESS_MEMORY_COUNTERS counters = {};
+	counters.cb = sizeof(counters);
+
+	if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+	{
+		return 0.0;
+	}
+
+	return static_cast<F64>(counters.PeakWorkingSetSize) / (1024.0 * 1024.0);
+}
@@ -0,0 +1,71 @@
+#pragma once
+
+#include "Application.h"
+
+#include <string>
+
+struct BenchmarkConfig
+{
+	U32			frameCount		= 1000;
+	U32			warmupFrames	= 60;
+	F64			tolerance		= 0.10;		// Allowed fractional slowdown against the baseline
+	U32			sceneTimeout	= 300;		// Seconds a scene process may run before it is killed and fails
+	std::string	outputPath		= "BenchmarkResults.json";
+	std::string	baselinePath;				// Empty : skip the baseline comparison
+	std::string	sceneName;					// Non-empty : run only this scene in the current process
+};
+
+struct BenchmarkResult
+{
+	std::string	scene;
+	U32			frameCount		= 0;
+	F64			startupMs		= 0.0;
+	F64			frameP50Ms		= 0.0;
+	F64			frameP95Ms		= 0.0;
+	F64			frameP99Ms		= 0.0;
+	F64			cpuSubmitMs		= 0.0;		// Average CPU time from image acquired to present returned : record, submit and present per frame
+	F64			peakMemoryMB	= 0.0;		// Peak working set of the process that ran the scene
+};
+
+struct BenchmarkReport
+{
+	std::string						build;
+	U32								frameCount		= 0;
+	U32								warmupFrames	= 0;
+	std::vector<BenchmarkResult>	scenes;
+};
+
+struct BenchmarkScene
+{
+	const char* name;
+	void (*Setup)(Application& app);					// Optional, runs after startup and before warmup
+	B32 (*Frame)(Application& app, U32 frameIndex);		// Returns whether the frame was submitted
+	void (*Teardown)(Application& app);					// Optional, runs before shutdown, also when the scene throws
+};
+
+class Benchmark
+{
+public:
+	Benchmark(const BenchmarkConfig& config);
+
+	void Run();
+	void WriteResults();
+	B32 CompareAgainstBaseline();
+
+private:
+	BenchmarkResult RunScene(const BenchmarkScene& scene);
+	BenchmarkResult RunSceneProcess(const BenchmarkScene& scene);
+
+	static BenchmarkReport ReadResults(const std::string& path);
+
+	static F64 Percentile(const std::vector<F64>& sortedFrameTimes, F64 percentile);
+	static F64 GetPeakMemoryMB();
+
+private:
+	BenchmarkConfig					m_config;
+	std::vector<BenchmarkResult>	m_results;
+
+private:
+	static const std::vector<BenchmarkScene> k_scenes;
+
+};
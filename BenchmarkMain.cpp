@@ -0,0 +1,124 @@
+#include "Benchmark.h"
+
+#include <cstring>
+#include <cerrno>
+#include <cmath>
+
+static void PrintUsage()
+{
+	std::cout << "Usage: VulkanEngineBenchmark [--frames N] [--warmup N] [--output file] [--baseline file] [--tolerance fraction] [--scene name] [--timeout seconds]" << std::endl;
+}
+
+static B32 ParseU32(const char* value, U32& result)
+{
+	char* end = nullptr;
+	errno = 0;
+	unsigned long parsed = std::strtoul(value, &end, 10);
+
+	if (value[0] == '-' || end == value || *end != '\0' || errno == ERANGE || parsed > std::numeric_limits<U32>::max())
+	{
+		return false;
+	}
+
+	result = static_cast<U32>(parsed);
+	return true;
+}
+
+static B32 ParseF64(const char* value, F64& result)
+{
+	char* end = nullptr;
+	errno = 0;
+	F64 parsed = std::strtod(value, &end);
+
+	if (end == value || *end != '\0' || errno == ERANGE || !std::isfinite(parsed))
+	{
+		return false;
+	}
+
+	result = parsed;
+	return true;
+}
+
+int main(int argc, char** argv)
+{
+	BenchmarkConfig config = {};
+
+#ifdef _DEBUG
+	std::cerr << "WARNING: Benchmark built with _DEBUG. Validation layers and the verbose debug callback are enabled, "
+		<< "so timings are not representative. Use the Release configuration for real numbers." << std::endl;
+#endif // _DEBUG
+
+	for (int i = 1; i < argc; i++)
+	{
+		const char* argument = argv[i];
+		const char* value = (i + 1 < argc) ? argv[i + 1] : nullptr;
+
+		if (value == nullptr)
+		{
+			PrintUsage();
+			return EXIT_FAILURE;
+		}
+
+		B32 isValid = true;
+
+		if (strcmp(argument, "--frames") == 0)			isValid = ParseU32(value, config.frameCount);
+		else if (strcmp(argument, "--warmup") == 0)		isValid = ParseU32(value, config.warmupFrames);
+		else if (strcmp(argument, "--output") == 0)		config.outputPath	= value;
+		else if (strcmp(argument, "--baseline") == 0)	config.baselinePath	= value;
+		else if (strcmp(argument, "--tolerance") == 0)	isValid = ParseF64(value, config.tolerance);
+		else if (strcmp(argument, "--scene") == 0)		config.sceneName	= value;
+		else if (strcmp(argument, "--timeout") == 0)	isValid = ParseU32(value, config.sceneTimeout);
+		else
+		{
+			PrintUsage();
+			return EXIT_FAILURE;
+		}
+
+		if (!isValid)
+		{
+			std::cerr << "Invalid value for " << argument << ": " << value << std::endl;
+			PrintUsage();
+			return EXIT_FAILURE;
+		}
+
+		i++;
+	}
+
+	if (config.frameCount == 0)
+	{
+		std::cerr << "--frames must be greater than 0" << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	if (config.sceneTimeout == 0)
+	{
+		std::cerr << "--timeout must be greater than 0" << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	if (config.tolerance < 0.0)
+	{
+		std::cerr << "--tolerance must not be negative" << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	try
+	{
+		Benchmark benchmark = Benchmark(config);
+
+		benchmark.Run();
+		benchmark.WriteResults();
+
+		if (!config.baselinePath.empty() && !benchmark.CompareAgainstBaseline())
+		{
+			return EXIT_FAILURE;
+		}
+	}
+	catch (const std::exception& e)
+	{
+		std::cerr << e.what() << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	return EXIT_SUCCESS;
+}
@@ -14,6 +14,9 @@
 #include <optional>
 #include <set>
 #include <algorithm>
+#include <cstring>
+#include <chrono>
+#include <functional>
 
 #include <GLFW/glfw3.h>
 #include <GLFW/glfw3native.h>